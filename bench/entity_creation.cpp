@@ -0,0 +1,44 @@
+#include "registry.hpp"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    constexpr std::size_t total = 1 << 22;
+
+    std::printf("%8s %14s %14s\n", "threads", "fresh (M/s)", "recycled (M/s)");
+    for (std::size_t threads = 1; threads <= 16; threads *= 2) {
+        double rates[2];
+
+        for (int recycle = 0; recycle < 2; recycle++) {
+            ecs::registry reg;
+
+            if (recycle) {
+                for (std::size_t i = 0; i < total; i++) {
+                    reg.create_entity();
+                }
+                for (std::size_t i = 0; i < total; i++) {
+                    reg.delete_entity(ecs::entity(i));
+                }
+            }
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (std::size_t t = 0; t < threads; t++) {
+                workers.emplace_back([&reg, threads]() {
+                    for (std::size_t i = 0; i < total / threads; i++) {
+                        reg.create_entity();
+                    }
+                });
+            }
+            for (auto &worker : workers) {
+                worker.join();
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            rates[recycle] = total / elapsed.count() / 1e6;
+        }
+        std::printf("%8zu %14.1f %14.1f\n", threads, rates[0], rates[1]);
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "registry.hpp"
+#include <chrono>
+#include <cstdio>
+
+struct position {
+    position(float x, float y) : x(x), y(y) {}
+    float x;
+    float y;
+};
+
+struct velocity {
+    velocity(float dx, float dy) : dx(dx), dy(dy) {}
+    float dx;
+    float dy;
+};
+
+struct health {
+    health(int hp) : hp(hp) {}
+    int hp;
+};
+
+int main()
+{
+    constexpr std::size_t entities = 50000;
+    constexpr std::size_t ticks = 1000;
+    constexpr std::size_t rollback = 8;
+    ecs::registry reg;
+
+    reg.register_component<position>();
+    reg.register_component<velocity>();
+    reg.register_component<health>();
+    for (std::size_t i = 0; i < entities; i++) {
+        auto e = reg.create_entity();
+        reg.emplace_component<position>(e, 0.0f, 0.0f);
+        reg.emplace_component<velocity>(e, 1.0f, 1.0f);
+        reg.emplace_component<health>(e, 100);
+    }
+    reg.snapshot();
+
+    double save = 0;
+    double restore = 0;
+    ecs::registry::snapshot_id last = 0;
+    for (std::size_t t = 0; t < ticks; t++) {
+        // Only the positions move during a tick
+        for (auto &p : reg.get_components<position>()) {
+            if (p.has_value()) {
+                p->x += 1.0f;
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        last = reg.snapshot();
+        auto middle = std::chrono::steady_clock::now();
+        if (t % rollback == rollback - 1) {
+            reg.get_components<position>()[0]->x = -1.0f;
+            reg.restore(last - rollback + 1);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        save += std::chrono::duration<double, std::micro>(middle - start).count();
+        restore += std::chrono::duration<double, std::micro>(end - middle).count();
+    }
+    std::printf("%zu entities, 3 components, 1 modified per tick\n", entities);
+    std::printf("snapshot        %8.1f us\n", save / ticks);
+    std::printf("restore         %8.1f us (every %zu ticks, %zu frames back)\n", restore / (ticks / rollback), rollback, rollback - 1);
+    return 0;
+}
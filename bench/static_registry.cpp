@@ -0,0 +1,130 @@
+#include "registry.hpp"
+#include "static_registry.hpp"
+#include <chrono>
+#include <cstdio>
+
+struct position {
+    position(float x, float y) : x(x), y(y) {}
+    float x;
+    float y;
+};
+
+struct velocity {
+    velocity(float dx, float dy) : dx(dx), dy(dy) {}
+    float dx;
+    float dy;
+};
+
+/**
+ * @brief Generic system, usable with both registries
+ */
+struct movement {
+    template <class Registry>
+    void operator()(Registry &, int, sparse_array<position> &positions, sparse_array<velocity> &velocities)
+    {
+        std::size_t size = std::min(positions.size(), velocities.size());
+        auto p = positions.begin();
+        auto v = velocities.begin();
+
+        for (std::size_t i = 0; i < size; i++) {
+            if (p[i].has_value() && v[i].has_value()) {
+                p[i]->x += v[i]->dx;
+                p[i]->y += v[i]->dy;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Generic system looking its components up through the registry for every entity
+ */
+struct lookup {
+    template <class Registry>
+    void operator()(Registry &reg, int, sparse_array<position> &positions, sparse_array<velocity> &)
+    {
+        for (std::size_t i = 0; i < positions.size(); i++) {
+            auto &v = reg.template get_components<velocity>()[i];
+            if (v.has_value()) {
+                v->dx = -v->dx;
+            }
+        }
+    }
+};
+
+constexpr std::size_t entities = 100000;
+constexpr std::size_t frames = 200;
+
+template <class Registry>
+static void populate(Registry &reg)
+{
+    reg.template register_component<position>();
+    reg.template register_component<velocity>();
+    for (std::size_t i = 0; i < entities; i++) {
+        auto e = reg.create_entity();
+        reg.template emplace_component<position>(e, 0.0f, 0.0f);
+        if (i % 2 == 0) {
+            reg.template emplace_component<velocity>(e, 1.0f, 1.0f);
+        }
+    }
+}
+
+template <class Function>
+static double measure(Function &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Registry>
+static double churn(Registry &reg)
+{
+    return measure([&reg]() {
+        for (std::size_t i = 0; i < entities; i++) {
+            auto e = reg.create_entity();
+            reg.template emplace_component<position>(e, 1.0f, 2.0f);
+            reg.template emplace_component<velocity>(e, 3.0f, 4.0f);
+            reg.delete_entity(e);
+        }
+    });
+}
+
+int main()
+{
+    using world_t = ecs::static_registry<position, velocity>;
+    using static_world_t = world_t::with_systems<
+        ecs::static_system<movement, position, velocity>,
+        ecs::static_system<lookup, position, velocity>
+    >;
+
+    ecs::registry dynamic_reg;
+    world_t static_reg;
+    static_world_t static_world;
+
+    populate(dynamic_reg);
+    populate(static_reg);
+    populate(static_world);
+
+    dynamic_reg.register_system<position, velocity>(movement{});
+    dynamic_reg.register_system<position, velocity>(lookup{});
+    dynamic_reg.enable_system<movement>();
+    dynamic_reg.enable_system<lookup>();
+    static_reg.register_system<position, velocity>(movement{});
+    static_reg.register_system<position, velocity>(lookup{});
+    static_reg.enable_system<movement>();
+    static_reg.enable_system<lookup>();
+
+    std::printf("%d entities, %d frames of movement + per-entity lookup\n", int(entities), int(frames));
+    std::printf("%-40s %10.1f ms\n", "ecs::registry",
+        measure([&]() { for (std::size_t f = 0; f < frames; f++) dynamic_reg.run_systems(); }));
+    std::printf("%-40s %10.1f ms\n", "ecs::static_registry (register_system)",
+        measure([&]() { for (std::size_t f = 0; f < frames; f++) static_reg.run_systems(); }));
+    std::printf("%-40s %10.1f ms\n", "ecs::static_registry::with_systems",
+        measure([&]() { for (std::size_t f = 0; f < frames; f++) static_world.run_systems(); }));
+
+    std::printf("%d create / emplace x2 / delete\n", int(entities));
+    std::printf("%-40s %10.1f ms\n", "ecs::registry", churn(dynamic_reg));
+    std::printf("%-40s %10.1f ms\n", "ecs::static_registry", churn(static_reg));
+    return 0;
+}
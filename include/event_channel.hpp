@@ -0,0 +1,193 @@
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+#ifndef EVENT_CHANNEL_HPP_
+    #define EVENT_CHANNEL_HPP_
+
+namespace ecs {
+
+/**
+ * @brief Base class of the event channels, used by the registry to swap them without knowing their type
+ */
+class ievent_channel {
+    public:
+        /**
+         * @brief Default destructor
+         */
+        virtual ~ievent_channel() = default;
+
+        /**
+         * @brief Merge the events sent by the worker threads and swap the buffers
+         */
+        virtual void update() = 0;
+
+        /**
+         * @brief Copy the channel, used when the registry is copied
+         * @return a new channel holding the same events
+         */
+        virtual std::unique_ptr<ievent_channel> clone() const = 0;
+};
+
+/**
+ * @brief Position of a reader in an event channel, each reader sees every event once
+ * @tparam Event the type of the events read
+ */
+template <class Event>
+struct event_reader {
+    std::size_t cursor = 0;
+};
+
+/**
+ * @brief Contiguous range of events returned by a read
+ * @tparam Event the type of the events
+ */
+template <class Event>
+class event_range {
+    public:
+        event_range(Event const *begin, Event const *end) : _begin(begin), _end(end) {}
+
+        Event const *begin() const { return _begin; }
+        Event const *end() const { return _end; }
+        std::size_t size() const { return static_cast<std::size_t>(_end - _begin); }
+        bool empty() const { return _begin == _end; }
+
+    private:
+        Event const *_begin;
+        Event const *_end;
+};
+
+/**
+ * @brief Double buffered channel of events of a single type.
+ * The events sent during a frame are written to the back buffer, and become readable
+ * once update() swaps it to the front at the frame boundary. They stay readable for that
+ * whole frame, then are dropped by the next update().
+ * @tparam Event the type of the events
+ */
+template <class Event>
+class event_channel : public ievent_channel {
+    public:
+
+        /**
+         * @brief Default constructor
+         */
+        event_channel() = default;
+
+        /**
+         * @brief Copy constructor
+         * @param other the channel to copy, the events not merged yet by its update() are
+         * added to the back buffer of the copy
+         * @note the copy gets its own id, the readers of the original can be used on it
+         */
+        event_channel(event_channel const &other);
+
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Sending
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Sending
+        /// @{
+
+        /**
+         * @brief Send an event, from the thread running the systems
+         * @param ...p the parameters to pass to the constructor of the event
+         */
+        template <class... Params>
+        void send(Params &&...p);
+
+        /**
+         * @brief Send an event from any thread, through a buffer owned by the calling thread
+         * @param ...p the parameters to pass to the constructor of the event
+         * @note the per-thread buffers are merged by update(), they must not be written meanwhile
+         */
+        template <class... Params>
+        void send_concurrent(Params &&...p);
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Reading
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Reading
+        /// @{
+
+        /**
+         * @brief Read the events of the front buffer the reader has not seen yet
+         * @param reader the reader, its cursor is moved past the events returned
+         * @return the events, valid until the next update()
+         */
+        event_range<Event> read(event_reader<Event> &reader) const;
+
+        /**
+         * @brief Get every event of the front buffer
+         * @return the events, valid until the next update()
+         */
+        event_range<Event> read_all() const;
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Frame boundary
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Frame boundary
+        /// @{
+
+        void update() override;
+
+        std::unique_ptr<ievent_channel> clone() const override;
+
+        /// @}
+
+    private:
+        /**
+         * @brief Get the buffer of the calling thread, creating it on first use
+         */
+        std::vector<Event> &local_buffer();
+
+        std::vector<Event> _front;
+        std::vector<Event> _back;
+
+        /**
+         * @brief Total number of events sent before the first one of the front buffer
+         */
+        std::size_t _front_start = 0;
+
+        /**
+         * @brief Get a token owned by the calling thread, released when the thread exits
+         */
+        static std::shared_ptr<void> const &thread_token();
+
+        /**
+         * @brief Buffer of a thread, with a weak reference on the token of that thread
+         */
+        struct thread_buffer_t {
+            std::weak_ptr<void> owner;
+            std::vector<Event> events;
+        };
+
+        /**
+         * @brief Buffers of the threads that sent events, owned by the channel so they die with it.
+         * They are kept in the order the threads first sent an event, which is the order update()
+         * merges them in, and the buffers of the threads that exited are dropped by update().
+         */
+        mutable std::mutex _mutex;
+        std::vector<std::unique_ptr<thread_buffer_t>> _thread_buffers;
+
+        /**
+         * @brief Unique id of the channel, checked by the single entry thread local cache
+         * so a destroyed channel is never dereferenced
+         */
+        std::size_t _id = _next_id++;
+        static inline std::atomic<std::size_t> _next_id = 1;
+};
+
+}
+
+#include "event_channel.tpp"
+
+#endif /* !EVENT_CHANNEL_HPP_ */
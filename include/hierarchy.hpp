@@ -0,0 +1,230 @@
+#include "sparse_array.hpp"
+#include "entity.hpp"
+#include <vector>
+#include <optional>
+#include <cstddef>
+
+#ifndef HIERARCHY_HPP_
+    #define HIERARCHY_HPP_
+
+namespace ecs {
+
+/**
+ * @class hierarchy
+ * @brief Parent / child relation between entities.
+ * The relations are stored in a dense array kept in depth-first order, a parent
+ * always being placed before its children, so a propagation from the roots to the
+ * leaves is a single linear sweep.
+ * The components stay indexed by entity id: propagate() reads each of them once from
+ * the sparse array in depth-first order, which only walks the sparse array linearly
+ * when the ids follow that order (for instance entities created parent first).
+ * Otherwise every entity costs one random access to the sparse array.
+ * @code
+ * auto &h = reg.get_hierarchy();
+ * h.set_parent(wheel, tank);
+ * h.propagate(reg.get_components<Transform>(), [](Transform const &parent, Transform &child) {
+ *     child.world = parent.world * child.local;
+ * });
+ * @endcode
+ */
+class hierarchy {
+    public:
+
+        /**
+         * @brief Value used for a missing parent, child or sibling
+         */
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Modifying the relations
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Modifying the relations
+        /// @{
+
+        /**
+         * @brief Attach an entity and its subtree as the first child of another entity
+         * @param child the entity to attach, added as a root first if unknown
+         * @param parent the new parent, added as a root first if unknown
+         * @throw std::invalid_argument if parent is child or one of its descendants
+         */
+        void set_parent(entity const &child, entity const &parent);
+
+        /**
+         * @brief Detach an entity and its subtree from its parent, making it a root
+         * @param child the entity to detach
+         */
+        void remove_parent(entity const &child);
+
+        /**
+         * @brief Remove a single entity from the hierarchy, its children become roots
+         * placed after the other roots
+         * @param e the entity to remove
+         */
+        void erase(entity const &e);
+
+        /**
+         * @brief Remove an entity and all its descendants from the hierarchy
+         * @param e the root of the subtree to remove
+         * @return the entities removed, in depth-first order
+         */
+        std::vector<entity> erase_subtree(entity const &e);
+
+        /**
+         * @brief Move the relations of an entity to another id
+         * @param from the current id of the entity
+         * @param to the new id, which must not be in the hierarchy
+         */
+        void rename(entity const &from, entity const &to);
+
+        /**
+         * @brief Remove every relation
+         */
+        void clear();
+
+        /**
+         * @brief Release the memory used by the ids above the highest entity of the hierarchy
+         */
+        void shrink_to_fit();
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Reading the relations
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Reading the relations
+        /// @{
+
+        /**
+         * @brief Check if an entity is part of the hierarchy
+         * @param e the entity
+         * @return true if the entity has been added to the hierarchy
+         */
+        bool contains(entity const &e) const;
+
+        /**
+         * @brief Get the parent of an entity
+         * @return the parent, or std::nullopt for a root or an unknown entity
+         */
+        std::optional<entity> parent(entity const &e) const;
+
+        /**
+         * @brief Get the first child of an entity
+         * @return the first child, or std::nullopt if the entity has no child
+         */
+        std::optional<entity> first_child(entity const &e) const;
+
+        /**
+         * @brief Get the next sibling of an entity
+         * @return the next sibling, or std::nullopt if the entity is the last child
+         */
+        std::optional<entity> next_sibling(entity const &e) const;
+
+        /**
+         * @brief Get the number of entities in the subtree of an entity, itself included
+         * @return the size of the subtree, 0 for an unknown entity
+         */
+        std::size_t subtree_size(entity const &e) const;
+
+        /**
+         * @brief Get the number of entities in the hierarchy
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Get the revision of the relations
+         * @note every modification draws a revision never used before by any hierarchy,
+         * so two hierarchies with the same revision are copies of the same state
+         * @return the revision
+         */
+        std::size_t revision() const;
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Traversal
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Traversal
+        /// @{
+
+        /**
+         * @brief Call a function on every entity, parents before children
+         * @param f called as `f(entity const &e, std::optional<entity> const &parent)`
+         */
+        template <class Function>
+        void each(Function &&f) const;
+
+        /**
+         * @brief Propagate a component from the parents to the children in a single linear sweep
+         * @param components the sparse array of the component
+         * @param f called as `f(Component const &parent, Component &child)` for every
+         * entity having a parent, when both have the component
+         * @note each component is looked up once in the sparse array and cached in depth-first
+         * order, the parent value is then read from that cache instead of the sparse array
+         */
+        template <class Component, class Function>
+        void propagate(sparse_array<Component> &components, Function &&f) const;
+
+        /// @}
+
+    private:
+
+        /**
+         * @brief Links of an entity, indexed by the entity id
+         */
+        struct node_t {
+            std::size_t parent = npos;
+            std::size_t first_child = npos;
+            std::size_t next_sibling = npos;
+            std::size_t position = npos;
+            std::size_t subtree_size = 1;
+        };
+
+        /**
+         * @brief Entry of the depth-first array, carrying its parent and subtree size
+         * to avoid a lookup while sweeping
+         */
+        struct link_t {
+            std::size_t entity;
+            std::size_t parent;
+            std::size_t subtree_size;
+        };
+
+        std::vector<node_t> _nodes;
+        std::vector<link_t> _order;
+        std::size_t _revision = 0;
+
+        /**
+         * @brief Give the hierarchy a new revision, called before every modification
+         */
+        void touch();
+
+        /**
+         * @brief Add an entity as a root if it is not in the hierarchy yet
+         */
+        void ensure(std::size_t e);
+
+        /**
+         * @brief Unlink an entity from its parent without moving its subtree
+         */
+        void detach(std::size_t e);
+
+        /**
+         * @brief Move the subtree of an entity so it starts before the given position
+         */
+        void move_subtree(std::size_t e, std::size_t to);
+
+        /**
+         * @brief Update the position of the entities between two positions of the depth-first array
+         */
+        void reindex(std::size_t from, std::size_t to);
+};
+
+}
+
+#include "hierarchy.tpp"
+
+#endif /* !HIERARCHY_HPP_ */
@@ -0,0 +1,101 @@
+#include "registry.hpp"
+#include <unordered_map>
+#include <typeindex>
+#include <functional>
+#include <vector>
+
+#ifndef PREFAB_HPP_
+    #define PREFAB_HPP_
+
+namespace ecs {
+
+/**
+ * @class prefab
+ * @brief A set of component values captured once and stamped on many entities
+ * with registry::instantiate()
+ * @code
+ * ecs::prefab tank;
+ * tank.set<Position>(0, 0).set<Health>(100).set<Turret>("cannon");
+ * auto tanks = reg.instantiate(tank, 50, [](ecs::registry &r, ecs::entity const &e, std::size_t i) {
+ *     r.get_components<Position>()[e]->x = i * 10;
+ * });
+ * @endcode
+ */
+class prefab {
+    public:
+
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Handle the components of the prefab
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Handling components
+        /// @{
+
+        /**
+         * @brief Set the value of a component of the prefab, replacing the previous one
+         * @tparam Component the component to set
+         * @tparam ...Params the parameters to pass to the constructor of the component
+         * @param ...p the parameters to pass to the constructor of the component
+         * @return the prefab itself, to chain the calls
+         */
+        template <class Component, class... Params>
+        prefab &set(Params &&...p);
+
+        /**
+         * @brief Remove a component from the prefab
+         * @tparam Component the component to remove
+         * @return the prefab itself, to chain the calls
+         */
+        template <class Component>
+        prefab &unset();
+
+        /**
+         * @brief Get the number of components of the prefab
+         * @return the number of components
+         */
+        std::size_t size() const;
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Stamping
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Stamping
+        /// @{
+
+        /**
+         * @brief Check that every component of the prefab is registered
+         * @param reg the registry holding the components
+         * @throw std::runtime_error if a component is not registered
+         */
+        void check(registry const &reg) const;
+
+        /**
+         * @brief Copy every component of the prefab to the entities given
+         * @param reg the registry holding the components
+         * @param entities the entities to stamp
+         * @note each sparse array is resolved and resized once for all the entities
+         */
+        void stamp(registry &reg, std::vector<entity> const &entities) const;
+
+        /// @}
+
+    private:
+
+        /**
+         * @brief Check the registration of a component and copy its column to a list of entities
+         */
+        struct column_t {
+            std::function<void(registry const &)> check;
+            std::function<void(registry &, std::vector<entity> const &)> stamp;
+        };
+        std::unordered_map<std::type_index, column_t> _columns;
+};
+
+}
+
+#include "prefab.tpp"
+
+#endif /* !PREFAB_HPP_ */
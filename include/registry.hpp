@@ -1,6 +1,8 @@
 #include "sparse_array.hpp"
 #include "entity.hpp"
 #include "isystem.hpp"
+#include "hierarchy.hpp"
+#include "event_channel.hpp"
 #include <unordered_map>
 #include <any>
 #include <typeindex>
@@ -10,12 +12,19 @@
 #include <functional>
 #include <list>
 #include <vector>
+#include <memory>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <atomic>
 
 #ifndef REGISTRY_HPP_
     #define REGISTRY_HPP_
 
 namespace ecs {
 
+class prefab;
+
 /**
  * @brief Diagramme UML pour la classe registry
  *
@@ -30,6 +39,10 @@ namespace ecs {
  *   + remove_component()
  *   + register_system()
  *   + run_systems()
+ *   + snapshot()
+ *   + restore()
+ *   + send()
+ *   + read()
  * }
  * class sparse_array {
  *   + register_component()
@@ -54,7 +67,7 @@ namespace ecs {
  * digraph registry {
  *     node [shape=record, fontname="Helvetica"];
  *
- *     registry [label="{ registry | + register_component() | + get_components() | + create_entity() | + entity_from_index() | + delete_entity() | + emplace_component() | + remove_component() | + register_system() | + run_systems() }"];
+ *     registry [label="{ registry | + register_component() | + get_components() | + create_entity() | + entity_from_index() | + delete_entity() | + emplace_component() | + remove_component() | + register_system() | + run_systems() | + snapshot() | + restore() | + send() | + read() }"];
  *     sparse_array [label="{ sparse_array\<\> | + operator[]() }"];
  *     entity [label="{ entity | + id: int | + operator size_t() }"];
  *     std_function [label="{ std::function | + operator()() }"];
@@ -114,6 +127,51 @@ class registry {
         template <class Component>
         void unregister_component();
 
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Memory of the components
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Memory of the components
+        /// @{
+
+        /**
+         * @brief Memory usage of the sparse array of a component
+         */
+        struct memory_stats_t {
+            std::string name;           ///< demangled name of the component
+            std::size_t live;           ///< number of components stored
+            std::size_t size;           ///< number of slots, holes included
+            std::size_t capacity;       ///< number of slots allocated
+            std::size_t bytes_used;     ///< bytes used by the slots
+            std::size_t bytes_reserved; ///< bytes allocated
+            double hole_ratio;          ///< proportion of the slots without a component
+        };
+
+        /**
+         * @brief Report the memory usage of every registered component
+         * @return the stats of each component
+         */
+        std::unordered_map<std::type_index, memory_stats_t> memory_stats() const;
+
+        /**
+         * @brief Trim the trailing holes of the sparse array of a component and release its unused memory
+         * @tparam Component the component to shrink
+         */
+        template <class Component>
+        void shrink();
+
+        /**
+         * @brief Shrink every sparse array and drop the unused entities at the end of the id space
+         * @param renumber if true, also move the entities with the highest ids into the
+         * unused ids so the id space has no holes left
+         * @warning renumbering changes the id of entities, any id stored outside of the
+         * registry must be updated using the returned pairs
+         * @return the pairs of old and new ids of the entities moved
+         */
+        std::vector<std::pair<entity, entity>> compact(bool renumber = false);
+
         /// @}
         /////////////////////////////////////////////////////////////
         /////////////////////////////////////////////////////////////
@@ -126,11 +184,34 @@ class registry {
         /**
          * @brief Give a new entity to the registry and return it
          * @note this function will increment the total entity count
-         * or take an entity from the unused entities set
+         * or take an entity from the unused entities list.
+         * It is lock-free and can be called from several threads at once, as long as
+         * no entity is deleted meanwhile. The components must be added at a sync point.
          * @return the new entity
          */
         entity create_entity();
 
+        /**
+         * @brief A contiguous range of entity ids
+         */
+        struct entity_range_t {
+            std::size_t first;
+            std::size_t count;
+
+            /**
+             * @brief Get the i-th entity of the range
+             */
+            entity operator[](std::size_t i) const { return entity(first + i); }
+        };
+
+        /**
+         * @brief Reserve a block of new contiguous entity ids
+         * @param n the number of entities to reserve
+         * @note this never reuses unused entities, and is thread-safe like create_entity()
+         * @return the range of entities reserved
+         */
+        entity_range_t reserve_entities(std::size_t n);
+
         /**
          * @brief Retrieve an entity from its index
          * @param idx the index of the entity
@@ -142,9 +223,48 @@ class registry {
          * @brief Delete all the components of an entity
          * @param e the entity to delete and add the unused entity to
          * the unused entities set
+         * @note deleting an entity that is already deleted or was never created does nothing
+         * @warning not thread-safe: it must not run while another thread is in
+         * create_entity() or reserve_entities()
          */
         void delete_entity(entity const &e);
 
+        /**
+         * @brief Delete an entity and all its descendants in the hierarchy in one batch
+         * @param e the root of the subtree to delete
+         * @warning not thread-safe, like delete_entity()
+         */
+        void delete_subtree(entity const &e);
+
+        /**
+         * @brief Retrieve the parent / child relations between the entities
+         * @return the hierarchy
+         */
+        hierarchy &get_hierarchy();
+
+        /**
+         * @brief Retrieve the parent / child relations between the entities but const
+         * @return the hierarchy as const
+         */
+        hierarchy const &get_hierarchy() const;
+
+        /**
+         * @brief Called on each entity created by instantiate(), with its position in the batch
+         */
+        using instance_callback_t = std::function<void(registry &, entity const &, std::size_t)>;
+
+        /**
+         * @brief Create entities in bulk from a prefab
+         * @param p the prefab holding the components to copy
+         * @param count the number of entities to create
+         * @param customize called on each entity after the components of the prefab are copied,
+         * used to override the values per instance
+         * @throw std::runtime_error if a component of the prefab is not registered,
+         * checked before any entity is created
+         * @return the entities created
+         */
+        std::vector<entity> instantiate(prefab const &p, std::size_t count, instance_callback_t const &customize = nullptr);
+
         /// @}
         /////////////////////////////////////////////////////////////
         /////////////////////////////////////////////////////////////
@@ -199,6 +319,41 @@ class registry {
         // template<class... Components, typename Function>
         // void register_system(Function& f);
 
+        /**
+         * @brief Limits of the work done in a frame by a budgeted system, 0 meaning no limit
+         * @note max_entities counts every slot scanned, holes included, so a sparse pool cannot
+         * stretch a frame. max_time is checked every 64 slots, so it can be exceeded by up to
+         * 64 calls of the system.
+         */
+        struct system_budget_t {
+            std::size_t max_entities = 0;
+            std::chrono::microseconds max_time = std::chrono::microseconds(0);
+        };
+
+        /**
+         * @brief Add a system that processes the entities one by one, stopping when its budget
+         * for the frame is spent and resuming from the same entity on the next frame.
+         * @tparam Components The components an entity needs to be processed.
+         * @tparam Function The type of the system.
+         *        The system must implement `void operator()(registry &, int, entity const &, Components& ...)`.
+         * @param f The system to add.
+         * @param budget The maximum number of entities or time spent per frame.
+         * @note The system is enabled, disabled and removed like any other system.
+         * An entity alive during a whole pass is processed exactly once in that pass,
+         * deleted entities are skipped and entities created behind the cursor are
+         * processed in the next pass.
+         */
+        template<class... Components, typename Function>
+        void register_budgeted_system(Function&& f, system_budget_t const &budget);
+
+        /**
+         * @brief Get the number of frames the last full pass of a budgeted system took
+         * @tparam Function the budgeted system
+         * @return the number of frames, 0 if no pass has been completed yet
+         */
+        template<typename Function>
+        std::size_t get_system_pass_frames() const;
+
 
         /**
          * @tparam Function, the type of the system
@@ -224,6 +379,7 @@ class registry {
 
         /**
          * @brief run all the enabled systems in the registry
+         * @note the event channels are updated before the systems run
          */
         void run_systems();
 
@@ -235,6 +391,104 @@ class registry {
         void run_single_system();
 
 
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Handle the events
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Handling events
+        /// @{
+
+        /**
+         * @brief Register an event type in the registry
+         * @tparam Event the type of the events
+         * @return the channel of the event
+         */
+        template <class Event>
+        event_channel<Event> &register_event();
+
+        /**
+         * @brief Retrieve the channel of a registered event
+         * @tparam Event the type of the events
+         * @return the channel of the event
+         */
+        template <class Event>
+        event_channel<Event> &get_events();
+
+        /**
+         * @brief Send an event, readable from the next frame
+         * @tparam Event the type of the event, must be registered
+         * @param ...p the parameters to pass to the constructor of the event
+         * @note use send_concurrent() from worker threads
+         */
+        template <class Event, class... Params>
+        void send(Params &&...p);
+
+        /**
+         * @brief Send an event from any thread, through a per-thread buffer merged at the next frame
+         * @tparam Event the type of the event, must be registered
+         * @param ...p the parameters to pass to the constructor of the event
+         */
+        template <class Event, class... Params>
+        void send_concurrent(Params &&...p);
+
+        /**
+         * @brief Read the events sent during the previous frame that the reader has not seen yet
+         * @tparam Event the type of the events, must be registered
+         * @param reader the cursor of the reader, each system reading the events keeps its own
+         * @return the events, valid until the next frame
+         */
+        template <class Event>
+        event_range<Event> read(event_reader<Event> &reader);
+
+        /**
+         * @brief Swap the buffers of every event channel, done by run_systems() at each frame
+         */
+        void update_events();
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Snapshots
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Snapshots
+        /// @{
+
+        /**
+         * @brief Identifier of a snapshot, increasing with each call to snapshot()
+         */
+        using snapshot_id = std::size_t;
+
+        /**
+         * @brief Save the state of every component and entity into the snapshot ring
+         * @note Only the sparse arrays accessed through a non-const method since the previous
+         * snapshot are copied, the others share its buffer, see sparse_array::dirty().
+         * @warning a component written through a reference or an iterator obtained before the
+         * previous snapshot is not detected, such references must not be kept across snapshots.
+         * When the ring is full, the oldest snapshot is overwritten and its buffers reused.
+         * @return the id of the snapshot
+         */
+        snapshot_id snapshot();
+
+        /**
+         * @brief Restore the registry to the state saved by snapshot()
+         * @param id the id of the snapshot to restore
+         * @note Only the sparse arrays modified since they were last saved or restored, or
+         * saved in a different state, are copied back.
+         * Components registered after the snapshot was taken are cleared.
+         * @throw std::out_of_range if the snapshot was overwritten or never taken
+         */
+        void restore(snapshot_id id);
+
+        /**
+         * @brief Set the number of snapshots kept in the ring, 8 by default
+         * @param capacity the number of snapshots
+         * @note this discards every snapshot already taken
+         */
+        void set_snapshot_capacity(std::size_t capacity);
+
         /// @}
 
     private :
@@ -247,11 +501,94 @@ class registry {
         using destructor_t = std::function<void(registry &, entity const &)>;
         std::unordered_map<std::type_index, destructor_t> _destructors;
 
+        /**
+         * @brief Type erased memory handling of the sparse arrays
+         */
+        struct pool_handler_t {
+            std::function<memory_stats_t(registry const &)> stats;
+            std::function<void(registry &)> shrink;
+            std::function<void(registry &, std::size_t, std::size_t)> relocate;
+        };
+        std::unordered_map<std::type_index, pool_handler_t> _pool_handlers;
+
+        /**
+         * @brief std::atomic that can be copied and moved, so the registry stays copyable and movable
+         * @note copying is not atomic as a whole, it must only happen at a sync point
+         */
+        template <class T>
+        struct sync_atomic : std::atomic<T> {
+            sync_atomic(T value = T()) : std::atomic<T>(value) {}
+            sync_atomic(sync_atomic const &other) : std::atomic<T>(other.load()) {}
+            sync_atomic &operator=(sync_atomic const &other) { this->store(other.load()); return *this; }
+            using std::atomic<T>::operator=;
+        };
+
         /**
          * @brief Keep track of unused entities and size of the registry
+         * @note _unused_entities is a stack of which only the first _unused_count ids are valid,
+         * popped with a compare and swap by create_entity() and only pushed by delete_entity().
+         * The ids left above _unused_count have been popped since the last sync point.
+         */
+        std::vector<std::size_t> _unused_entities;
+        sync_atomic<std::size_t> _unused_count = 0;
+        sync_atomic<std::size_t> _total_entity_count = 0;
+
+        /**
+         * @brief Flag set for every id currently in the unused entities stack, indexed by id
+         * @note create_entity() does not clear it, the popped ids are cleared at the next sync point
+         */
+        std::vector<bool> _released_entities;
+
+        /**
+         * @brief Clear the flag of the ids popped since the last sync point and drop them from the stack
+         */
+        void sync_unused_entities();
+
+        /**
+         * @brief Rebuild the released flags from the unused entities stack
+         */
+        void rebuild_released_entities();
+
+        /**
+         * @brief Check if an id is not a living entity
+         * @return true if the id is in the unused entities stack or was never created
+         */
+        bool is_released(std::size_t e);
+
+        /**
+         * @brief Push an entity on the unused entities stack
          */
-        std::set<entity> _unused_entities;
-        std::size_t _total_entity_count = 0;
+        void release_entity(std::size_t e);
+
+        /**
+         * @brief Parent / child relations between the entities
+         */
+        hierarchy _hierarchy;
+
+        /**
+         * @brief Map of the event channels that clones them when copied, so the registry stays copyable
+         */
+        struct event_channels_t : std::unordered_map<std::type_index, std::unique_ptr<ievent_channel>> {
+            event_channels_t() = default;
+            event_channels_t(event_channels_t &&) = default;
+            event_channels_t &operator=(event_channels_t &&) = default;
+            event_channels_t(event_channels_t const &other) : unordered_map() { *this = other; }
+            event_channels_t &operator=(event_channels_t const &other)
+            {
+                if (this != &other) {
+                    this->clear();
+                    for (auto const &[type, channel] : other) {
+                        this->emplace(type, channel->clone());
+                    }
+                }
+                return *this;
+            }
+        };
+
+        /**
+         * @brief Channels of the events, one per event type
+         */
+        event_channels_t _event_channels;
 
         /**
          * @brief Handle the systems
@@ -259,10 +596,51 @@ class registry {
         std::unordered_map<std::type_index, std::function<void(registry &, int)>> _systems;
         std::unordered_set<std::type_index> _enabled_systems;
 
+        /**
+         * @brief Progress of the budgeted systems across frames
+         */
+        struct system_cursor_t {
+            std::size_t position = 0;
+            std::size_t frames = 0;
+            std::size_t last_pass_frames = 0;
+        };
+        std::unordered_map<std::type_index, std::shared_ptr<system_cursor_t>> _system_cursors;
+
         /**
          * @brief time handler
          */
         int _last_time = 0;
+
+        /**
+         * @brief Type erased save and load of a sparse array, along with the buffer
+         * it was last synchronized with
+         */
+        struct snapshot_handler_t {
+            std::function<std::shared_ptr<void>(registry &, std::shared_ptr<void>)> save;
+            std::function<void(registry &, std::shared_ptr<void> const &)> load;
+            std::function<bool(registry const &)> dirty;
+            std::shared_ptr<void> last_buffer;
+        };
+        std::unordered_map<std::type_index, snapshot_handler_t> _snapshot_handlers;
+
+        /**
+         * @brief A slot of the snapshot ring
+         */
+        struct snapshot_slot_t {
+            snapshot_id id = 0;
+            bool valid = false;
+            std::unordered_map<std::type_index, std::shared_ptr<void>> pools;
+            std::vector<std::size_t> unused_entities;
+            std::size_t total_entity_count = 0;
+            std::shared_ptr<hierarchy> relations;
+        };
+        std::vector<snapshot_slot_t> _snapshots = std::vector<snapshot_slot_t>(8);
+        snapshot_id _next_snapshot = 0;
+
+        /**
+         * @brief Copy of the hierarchy shared by the snapshots while it does not change
+         */
+        std::shared_ptr<hierarchy> _last_relations;
 };
 
 
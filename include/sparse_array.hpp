@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <optional>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
 /**
  * @brief A sparse array is a container that can store components at specific positions
@@ -152,6 +155,29 @@ public:
      */
     size_type size() const;
 
+    /**
+     * @brief Get the number of components actually stored, holes excluded
+     * @return the number of components
+     */
+    size_type count() const;
+
+    /**
+     * @brief Get the number of slots allocated by the container
+     * @return the capacity
+     */
+    size_type capacity() const;
+
+    /**
+     * @brief Remove the trailing holes and release the unused memory of the container
+     */
+    void shrink_to_fit();
+
+    /**
+     * @brief Ensure the container has a slot at a given position
+     * @param size the position that must be accessible
+     */
+    void ensure_size(size_type size);
+
     /**
      * @brief Insert a component at a specific position by copy
      * @param pos the position
@@ -193,6 +219,41 @@ public:
         
     size_type get_index(value_type const&) const;
 
+    /// @}
+    ///////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////
+    //      Snapshot
+    ///////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////
+    /// @name Snapshot
+    /// @{
+
+    /**
+     * @brief Check if the sparse array may have changed since the last clear_dirty()
+     * @note the flag is set by every non-const access (operator[], begin(), end(), insertion,
+     * erase...), so writes through a reference or an iterator obtained before clear_dirty()
+     * are not seen. Such references must not be kept across a snapshot.
+     * @return true if the sparse array may have changed
+     */
+    bool dirty() const;
+
+    /**
+     * @brief Mark the current content as saved
+     */
+    void clear_dirty();
+
+    /**
+     * @brief Copy the content of the sparse array into a buffer
+     * @param dest the buffer, its capacity is reused when possible
+     */
+    void copy_to(container_t &dest) const;
+
+    /**
+     * @brief Replace the content of the sparse array by a buffer
+     * @param src the buffer to copy from
+     */
+    void copy_from(container_t const &src);
+
     /// @}
 private:
     /**
@@ -201,10 +262,17 @@ private:
     container_t _data;
 
     /**
-     * @brief Ensure the size of the container
-     * @param size the size
+     * @brief Set by every access that may modify the container, cleared by snapshots
      */
-    void ensure_size(size_type size);
+    bool _dirty = true;
+
+    /**
+     * @brief Copy a container into another, using memcpy when the components are trivially copyable
+     * @param dest the destination
+     * @param src the source
+     */
+    static void copy_container(container_t &dest, container_t const &src);
+
 };
 
 // Inclusion des définitions de la classe template
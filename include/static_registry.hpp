@@ -0,0 +1,309 @@
+#include "sparse_array.hpp"
+#include "entity.hpp"
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <typeindex>
+#include <functional>
+#include <vector>
+
+#ifndef STATIC_REGISTRY_HPP_
+    #define STATIC_REGISTRY_HPP_
+
+namespace ecs {
+
+/**
+ * @class static_registry
+ * @brief Registry whose set of components is known at compile time.
+ * The sparse arrays are stored in a tuple, so accessing a component resolves at
+ * compile time instead of going through std::type_index and std::any.
+ * It keeps the same interface as ecs::registry for the components, entities and systems,
+ * so code written with generic systems can switch from one to the other.
+ * @note Only systems taking the registry as a generic parameter (`auto &reg`, or a templated
+ * operator()) are portable. Systems inheriting from ecs::isystem take an `ecs::registry &`
+ * and can only be registered on ecs::registry.
+ * @tparam Components every component the registry can hold
+ * @code
+ * ecs::static_registry<Position, Velocity> reg;
+ * auto e = reg.create_entity();
+ * reg.emplace_component<Position>(e, 0, 0);
+ * reg.run_system<Position, Velocity>([](auto &reg, int dt, auto &positions, auto &velocities) {
+ *     // do something
+ * });
+ *
+ * // systems known at compile time, run in order by a fold without any type erasure
+ * ecs::static_registry<Position, Velocity>::with_systems<
+ *     ecs::static_system<Movement, Position, Velocity>,
+ *     ecs::static_system<Friction, Velocity>
+ * > world;
+ * world.run_systems();
+ * @endcode
+ */
+template <class... Components>
+class static_registry {
+    public :
+
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Handle the components in the registry
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Registering components
+        /// @{
+
+        /**
+         * @brief Check at compile time that a component is part of the registry
+         */
+        template <class Component>
+        static constexpr bool has_component = (std::is_same_v<Component, Components> || ...);
+
+        /**
+         * @brief Kept for parity with ecs::registry, the components are all registered at compile time
+         * @tparam Component 
+         * @return The sparse array of the component
+         */
+        template <class Component>
+        sparse_array<Component> &register_component();
+
+        /**
+         * @brief Retrieve the sparse array of a component
+         * @tparam Component, must be one of the components of the registry
+         * @return the sparse array of the component
+         */
+        template <class Component>
+        sparse_array<Component> &get_components();
+
+        /**
+         * @brief Retrieve the sparse array of a component but const
+         * @tparam Component, must be one of the components of the registry
+         * @return the sparse array of the component as const
+         */
+        template <class Component>
+        sparse_array<Component> const &get_components() const;
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Handle the entities in the registry
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Handling entities
+        /// @{
+
+        /**
+         * @brief Give a new entity to the registry and return it
+         * @note this function will increment the total entity count
+         * or take an entity from the unused entities list
+         * @return the new entity
+         */
+        entity create_entity();
+
+        /**
+         * @brief Retrieve an entity from its index
+         * @param idx the index of the entity
+         * @return the entity
+         */
+        entity entity_from_index(std::size_t idx);
+
+        /**
+         * @brief Delete all the components of an entity
+         * @param e the entity to delete and add to the unused entities
+         * @note deleting an entity that is already deleted or was never created does nothing
+         */
+        void delete_entity(entity const &e);
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Handle the components in the registry
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Handling components
+        /// @{
+
+        /**
+         * @brief add a component to an entity and return it
+         * @tparam Component : the component to add
+         * @tparam ...Params : the parameters to pass to the constructor of the component
+         * @param to : the entity to add the component to
+         * @param ...p : the parameters to pass to the constructor of the component
+         * @return return the component just added
+         */
+        template<typename Component, typename ...Params>
+        typename sparse_array<Component>::reference_type emplace_component(entity const &to, Params &&...p);
+
+        /**
+         * @brief remove a component from an entity
+         * @tparam Component the component to remove
+         * @param from the entity to remove the component from
+         */
+        template<typename Component>
+        void remove_component(entity const &from);
+
+        /// @}
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        //      Handle the systems
+        /////////////////////////////////////////////////////////////
+        /////////////////////////////////////////////////////////////
+        /// @name Handling systems
+        /// @{
+
+        /**
+         * @brief Run a system once, right now, without storing it
+         * @tparam Used The components used by the system.
+         * @param f The system, called as `f(static_registry &, int, sparse_array<Used> &...)`.
+         * @param elapsed_time The time passed to the system.
+         * @note Nothing is type erased here, so the call and the component accesses can be inlined.
+         */
+        template<class... Used, typename Function>
+        void run_system(Function&& f, int elapsed_time = 0);
+
+        /**
+         * @brief Add a system to the registry that operates on specific components.
+         * @tparam Used The components used by the system.
+         * @tparam Function The type of the system.
+         *        The system must implement `void operator()(static_registry &, int, sparse_array<Used>& ...)`.
+         * @param f The system to add.
+         * @note The system itself is stored behind a std::function, one indirect call per
+         *       frame, but the sparse arrays it receives are resolved at compile time.
+         */
+        template<class... Used, typename Function>
+        void register_system(Function&& f);
+
+        /**
+         * @tparam Function, the type of the system
+         * it removes the system from the registry.
+         */
+        template<typename Function>
+        void unregister_syste();
+
+        /**
+         * @tparam Funciton, the system to enable
+         * @brief enable the system, so it runs with with the method "runs_system()".
+         * The system needs to be added before being enabled
+         */
+        template<typename Function>
+        void enable_system();
+
+        /**
+         * @tparam Function, the system to disable
+         * @brief disable the system given. It will no longer runs with run_systems.
+         */
+        template<typename Function>
+        void disable_system();
+
+        /**
+         * @brief run all the enabled systems in the registry
+         */
+        void run_systems();
+
+        /**
+         * @brief run a single system in the registry, the system must be registered
+         */
+        template <typename Function>
+        void run_single_system();
+
+        /**
+         * @brief The same registry with a list of systems fixed at compile time
+         * @tparam Systems ecs::static_system entries, run in this order by run_systems()
+         */
+        template <class... Systems>
+        class with_systems;
+
+        /// @}
+
+    protected :
+
+        /**
+         * @brief Compute the time elapsed since the previous frame, in milliseconds
+         */
+        int next_elapsed_time();
+
+        /**
+         * @brief Run the systems enabled with enable_system()
+         * @param elapsed_time the time passed to the systems
+         */
+        void run_registered_systems(int elapsed_time);
+
+    private :
+
+        std::tuple<sparse_array<Components>...> _pools;
+
+        /**
+         * @brief Keep track of unused entities and size of the registry
+         */
+        std::vector<std::size_t> _unused_entities;
+        std::size_t _total_entity_count = 0;
+
+        /**
+         * @brief Flag set for every id currently in the unused entities, indexed by id
+         */
+        std::vector<bool> _released_entities;
+
+        /**
+         * @brief Handle the systems
+         */
+        std::unordered_map<std::type_index, std::function<void(static_registry &, int)>> _systems;
+        std::unordered_set<std::type_index> _enabled_systems;
+
+        /**
+         * @brief time handler
+         */
+        int _last_time = 0;
+};
+
+/**
+ * @brief Entry of the compile-time system list of static_registry::with_systems
+ * @tparam System the type of the system, default constructed by the registry
+ * @tparam Used the components given to the system, called as
+ * `system(registry &, int, sparse_array<Used> &...)`
+ */
+template <class System, class... Used>
+struct static_system {
+    using system_type = System;
+    System system;
+};
+
+template <class... Components>
+template <class... Systems>
+class static_registry<Components...>::with_systems : public static_registry<Components...> {
+    public :
+
+        /**
+         * @brief Retrieve a system of the list, to configure it
+         * @tparam System the type of the system, must be in the list
+         * @return the system
+         */
+        template <class System>
+        System &get_system();
+
+        /**
+         * @brief Run the systems of the list in order, then the systems enabled at runtime
+         * @note the list is dispatched by a fold, every call can be inlined
+         */
+        void run_systems();
+
+    private :
+
+        /**
+         * @brief Find the position of a system in the list at compile time
+         */
+        template <class System, std::size_t I = 0>
+        static constexpr std::size_t system_index();
+
+        /**
+         * @brief Call a system with the sparse arrays it uses
+         */
+        template <class System, class... Used>
+        void run_entry(static_system<System, Used...> &entry, int elapsed_time);
+
+        std::tuple<Systems...> _static_systems;
+};
+
+}
+
+#include "static_registry.tpp"
+
+#endif /* !STATIC_REGISTRY_HPP_ */
@@ -0,0 +1,29 @@
+#include <string>
+#include <memory>
+#include <typeinfo>
+#include <cstdlib>
+#include <cxxabi.h>
+
+#ifndef TYPE_NAME_HPP_
+    #define TYPE_NAME_HPP_
+
+/**
+ * @brief Get the readable name of a type, used in the error messages
+ * @tparam T the type
+ * @return the demangled name, or the mangled one if it cannot be demangled
+ */
+template <typename T>
+static std::string get_type_name()
+{
+    const char* mangled = typeid(T).name();
+    int status = 0;
+
+    std::unique_ptr<char, void(*)(void*)> demangled(
+        abi::__cxa_demangle(mangled, nullptr, nullptr, &status),
+        std::free
+    );
+
+    return (status == 0) ? demangled.get() : mangled;
+}
+
+#endif /* !TYPE_NAME_HPP_ */
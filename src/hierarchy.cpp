@@ -0,0 +1,247 @@
+#include "hierarchy.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <atomic>
+
+static std::atomic<std::size_t> next_revision = 1;
+
+void ecs::hierarchy::set_parent(entity const &child, entity const &parent)
+{
+    this->ensure(child);
+    this->ensure(parent);
+
+    auto &c = this->_nodes[child];
+    auto &p = this->_nodes[parent];
+
+    if (p.position >= c.position && p.position < c.position + c.subtree_size) {
+        throw std::invalid_argument("Cannot make an entity the child of itself or of one of its descendants");
+    }
+    if (c.parent == parent) {
+        return;
+    }
+    this->touch();
+    this->detach(child);
+    this->move_subtree(child, p.position + 1);
+
+    c.parent = parent;
+    c.next_sibling = p.first_child;
+    p.first_child = child;
+    this->_order[c.position].parent = parent;
+    for (std::size_t a = parent; a != npos; a = this->_nodes[a].parent) {
+        this->_nodes[a].subtree_size += c.subtree_size;
+        this->_order[this->_nodes[a].position].subtree_size = this->_nodes[a].subtree_size;
+    }
+}
+
+void ecs::hierarchy::remove_parent(entity const &child)
+{
+    if (!this->contains(child) || this->_nodes[child].parent == npos) {
+        return;
+    }
+    this->touch();
+    this->detach(child);
+    this->move_subtree(child, this->_order.size());
+}
+
+void ecs::hierarchy::erase(entity const &e)
+{
+    if (!this->contains(e)) {
+        return;
+    }
+    this->touch();
+    this->detach(e);
+
+    std::size_t from = this->_nodes[e].position;
+    std::size_t count = this->_nodes[e].subtree_size;
+    auto begin = this->_order.begin();
+
+    for (std::size_t c = this->_nodes[e].first_child; c != npos;) {
+        std::size_t next = this->_nodes[c].next_sibling;
+
+        this->_nodes[c].parent = npos;
+        this->_nodes[c].next_sibling = npos;
+        this->_order[this->_nodes[c].position].parent = npos;
+        c = next;
+    }
+    // The children keep their subtrees, moved in one block after the other roots
+    std::rotate(begin + from, begin + from + count, this->_order.end());
+    this->_order.erase(this->_order.end() - count);
+    this->_nodes[e] = node_t();
+    this->reindex(from, this->_order.size());
+}
+
+std::vector<ecs::entity> ecs::hierarchy::erase_subtree(entity const &e)
+{
+    std::vector<entity> removed;
+
+    if (!this->contains(e)) {
+        return removed;
+    }
+    this->touch();
+    this->detach(e);
+
+    std::size_t from = this->_nodes[e].position;
+    std::size_t to = from + this->_nodes[e].subtree_size;
+
+    removed.reserve(to - from);
+    for (std::size_t i = from; i < to; i++) {
+        removed.emplace_back(this->_order[i].entity);
+        this->_nodes[this->_order[i].entity] = node_t();
+    }
+    this->_order.erase(this->_order.begin() + from, this->_order.begin() + to);
+    this->reindex(from, this->_order.size());
+    return removed;
+}
+
+void ecs::hierarchy::rename(entity const &from, entity const &to)
+{
+    if (!this->contains(from) || from == to) {
+        return;
+    }
+    if (this->contains(to)) {
+        throw std::invalid_argument("Cannot rename an entity to an id already in the hierarchy");
+    }
+    if (this->_nodes.size() <= to) {
+        this->_nodes.resize(to + 1);
+    }
+    node_t node = this->_nodes[from];
+
+    this->touch();
+    this->_nodes[from] = node_t();
+    this->_nodes[to] = node;
+    this->_order[node.position].entity = to;
+    if (node.parent != npos) {
+        std::size_t *link = &this->_nodes[node.parent].first_child;
+        while (*link != from) {
+            link = &this->_nodes[*link].next_sibling;
+        }
+        *link = to;
+    }
+    for (std::size_t c = node.first_child; c != npos; c = this->_nodes[c].next_sibling) {
+        this->_nodes[c].parent = to;
+        this->_order[this->_nodes[c].position].parent = to;
+    }
+}
+
+void ecs::hierarchy::clear()
+{
+    this->touch();
+    this->_nodes.clear();
+    this->_order.clear();
+}
+
+void ecs::hierarchy::shrink_to_fit()
+{
+    std::size_t last = this->_nodes.size();
+
+    while (last > 0 && this->_nodes[last - 1].position == npos) {
+        --last;
+    }
+    this->_nodes.resize(last);
+    this->_nodes.shrink_to_fit();
+    this->_order.shrink_to_fit();
+}
+
+bool ecs::hierarchy::contains(entity const &e) const
+{
+    return e < this->_nodes.size() && this->_nodes[e].position != npos;
+}
+
+std::optional<ecs::entity> ecs::hierarchy::parent(entity const &e) const
+{
+    if (!this->contains(e) || this->_nodes[e].parent == npos) {
+        return std::nullopt;
+    }
+    return entity(this->_nodes[e].parent);
+}
+
+std::optional<ecs::entity> ecs::hierarchy::first_child(entity const &e) const
+{
+    if (!this->contains(e) || this->_nodes[e].first_child == npos) {
+        return std::nullopt;
+    }
+    return entity(this->_nodes[e].first_child);
+}
+
+std::optional<ecs::entity> ecs::hierarchy::next_sibling(entity const &e) const
+{
+    if (!this->contains(e) || this->_nodes[e].next_sibling == npos) {
+        return std::nullopt;
+    }
+    return entity(this->_nodes[e].next_sibling);
+}
+
+std::size_t ecs::hierarchy::subtree_size(entity const &e) const
+{
+    return this->contains(e) ? this->_nodes[e].subtree_size : 0;
+}
+
+std::size_t ecs::hierarchy::size() const
+{
+    return this->_order.size();
+}
+
+std::size_t ecs::hierarchy::revision() const
+{
+    return this->_revision;
+}
+
+void ecs::hierarchy::touch()
+{
+    this->_revision = next_revision.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ecs::hierarchy::ensure(std::size_t e)
+{
+    if (this->_nodes.size() <= e) {
+        this->_nodes.resize(e + 1);
+    }
+    if (this->_nodes[e].position == npos) {
+        this->_nodes[e].position = this->_order.size();
+        this->_order.push_back({e, npos, 1});
+        this->touch();
+    }
+}
+
+void ecs::hierarchy::detach(std::size_t e)
+{
+    auto &node = this->_nodes[e];
+
+    if (node.parent == npos) {
+        return;
+    }
+    std::size_t *link = &this->_nodes[node.parent].first_child;
+    while (*link != e) {
+        link = &this->_nodes[*link].next_sibling;
+    }
+    *link = node.next_sibling;
+    for (std::size_t a = node.parent; a != npos; a = this->_nodes[a].parent) {
+        this->_nodes[a].subtree_size -= node.subtree_size;
+        this->_order[this->_nodes[a].position].subtree_size = this->_nodes[a].subtree_size;
+    }
+    node.parent = npos;
+    node.next_sibling = npos;
+    this->_order[node.position].parent = npos;
+}
+
+void ecs::hierarchy::move_subtree(std::size_t e, std::size_t to)
+{
+    std::size_t from = this->_nodes[e].position;
+    std::size_t count = this->_nodes[e].subtree_size;
+    auto begin = this->_order.begin();
+
+    if (to > from + count) {
+        std::rotate(begin + from, begin + from + count, begin + to);
+        this->reindex(from, to);
+    } else if (to < from) {
+        std::rotate(begin + to, begin + from, begin + from + count);
+        this->reindex(to, from + count);
+    }
+}
+
+void ecs::hierarchy::reindex(std::size_t from, std::size_t to)
+{
+    for (std::size_t i = from; i < to; i++) {
+        this->_nodes[this->_order[i].entity].position = i;
+    }
+}
@@ -0,0 +1,20 @@
+#include "prefab.hpp"
+
+std::size_t ecs::prefab::size() const
+{
+    return this->_columns.size();
+}
+
+void ecs::prefab::check(registry const &reg) const
+{
+    for (auto const &column : this->_columns) {
+        column.second.check(reg);
+    }
+}
+
+void ecs::prefab::stamp(registry &reg, std::vector<entity> const &entities) const
+{
+    for (auto const &column : this->_columns) {
+        column.second.stamp(reg, entities);
+    }
+}
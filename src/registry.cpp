@@ -1,18 +1,113 @@
 #include "registry.hpp"
 #include "entity.hpp"
+#include "prefab.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+std::unordered_map<std::type_index, ecs::registry::memory_stats_t> ecs::registry::memory_stats() const
+{
+    std::unordered_map<std::type_index, memory_stats_t> stats;
+
+    for (auto const &[type, handler] : this->_pool_handlers) {
+        stats.emplace(type, handler.stats(*this));
+    }
+    return stats;
+}
+
+std::vector<std::pair<ecs::entity, ecs::entity>> ecs::registry::compact(bool renumber)
+{
+    std::vector<std::pair<entity, entity>> moved;
+
+    this->sync_unused_entities();
+    std::vector<std::size_t> unused(this->_unused_entities.begin(), this->_unused_entities.end());
+    std::size_t total = this->_total_entity_count;
+    std::size_t next_hole = 0;
+    auto trim = [&]() {
+        while (next_hole < unused.size() && unused.back() == total - 1) {
+            unused.pop_back();
+            total--;
+        }
+    };
+
+    std::sort(unused.begin(), unused.end());
+    trim();
+    // The highest id is always alive after trim(), so it is moved into the lowest hole
+    while (renumber && next_hole < unused.size()) {
+        entity hole(unused[next_hole++]);
+        entity last(total - 1);
+
+        for (auto &handler : this->_pool_handlers) {
+            handler.second.relocate(*this, last, hole);
+        }
+        this->_hierarchy.rename(last, hole);
+        total--;
+        moved.emplace_back(last, hole);
+        trim();
+    }
+    // Stored from the highest to the lowest so the lowest ids are reused first
+    this->_unused_entities.assign(unused.rbegin(), unused.rend() - next_hole);
+    this->_unused_entities.shrink_to_fit();
+    this->_unused_count = this->_unused_entities.size();
+    this->_total_entity_count = total;
+    this->rebuild_released_entities();
+    for (auto &handler : this->_pool_handlers) {
+        handler.second.shrink(*this);
+    }
+    this->_hierarchy.shrink_to_fit();
+    return moved;
+}
 
 ecs::entity ecs::registry::create_entity()
 {
-    if (this->_unused_entities.empty()) {
-        auto e = entity(this->_total_entity_count);
-        this->_total_entity_count++;
-        return e;
+    std::size_t count = this->_unused_count.load(std::memory_order_acquire);
+
+    while (count != 0) {
+        if (this->_unused_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel)) {
+            return this->entity_from_index(this->_unused_entities[count - 1]);
+        }
+    }
+    return this->entity_from_index(this->_total_entity_count.fetch_add(1, std::memory_order_relaxed));
+}
+
+ecs::registry::entity_range_t ecs::registry::reserve_entities(std::size_t n)
+{
+    return entity_range_t{this->_total_entity_count.fetch_add(n, std::memory_order_relaxed), n};
+}
+
+void ecs::registry::sync_unused_entities()
+{
+    std::size_t count = this->_unused_count.load(std::memory_order_acquire);
+
+    for (std::size_t i = count; i < this->_unused_entities.size(); i++) {
+        this->_released_entities[this->_unused_entities[i]] = false;
+    }
+    this->_unused_entities.resize(count);
+}
+
+void ecs::registry::rebuild_released_entities()
+{
+    this->_released_entities.assign(this->_total_entity_count, false);
+    for (std::size_t i = 0; i < this->_unused_count; i++) {
+        this->_released_entities[this->_unused_entities[i]] = true;
     }
+}
+
+bool ecs::registry::is_released(std::size_t e)
+{
+    this->sync_unused_entities();
+    return e >= this->_total_entity_count
+        || (e < this->_released_entities.size() && this->_released_entities[e]);
+}
 
-    // Retirer l'entité de _unused_entities et la retourner directement
-    std::size_t entity = *this->_unused_entities.begin();
-    this->_unused_entities.erase(this->_unused_entities.begin());
-    return this->entity_from_index(entity);
+void ecs::registry::release_entity(std::size_t e)
+{
+    this->sync_unused_entities();
+    if (this->_released_entities.size() <= e) {
+        this->_released_entities.resize(e + 1);
+    }
+    this->_released_entities[e] = true;
+    this->_unused_entities.push_back(e);
+    this->_unused_count.store(this->_unused_entities.size(), std::memory_order_release);
 }
 
 ecs::entity ecs::registry::entity_from_index(std::size_t idx)
@@ -22,10 +117,64 @@ ecs::entity ecs::registry::entity_from_index(std::size_t idx)
 
 void ecs::registry::delete_entity(entity const &e)
 {
+    if (this->is_released(e)) {
+        return;
+    }
     for (auto &destructor : this->_destructors) {
         destructor.second(*this, e);
     }
-    this->_unused_entities.insert(e);
+    this->_hierarchy.erase(e);
+    this->release_entity(e);
+}
+
+void ecs::registry::delete_subtree(entity const &e)
+{
+    if (!this->_hierarchy.contains(e)) {
+        this->delete_entity(e);
+        return;
+    }
+    auto entities = this->_hierarchy.erase_subtree(e);
+
+    entities.erase(std::remove_if(entities.begin(), entities.end(), [this](entity const &child) {
+        return this->is_released(child);
+    }), entities.end());
+
+    for (auto &destructor : this->_destructors) {
+        for (auto const &child : entities) {
+            destructor.second(*this, child);
+        }
+    }
+    for (auto const &child : entities) {
+        this->release_entity(child);
+    }
+}
+
+ecs::hierarchy &ecs::registry::get_hierarchy()
+{
+    return this->_hierarchy;
+}
+
+ecs::hierarchy const &ecs::registry::get_hierarchy() const
+{
+    return this->_hierarchy;
+}
+
+std::vector<ecs::entity> ecs::registry::instantiate(prefab const &p, std::size_t count, instance_callback_t const &customize)
+{
+    std::vector<entity> entities;
+
+    p.check(*this);
+    entities.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        entities.push_back(this->create_entity());
+    }
+    p.stamp(*this, entities);
+    if (customize) {
+        for (std::size_t i = 0; i < count; i++) {
+            customize(*this, entities[i], i);
+        }
+    }
+    return entities;
 }
 
 void ecs::registry::run_systems(void)
@@ -39,8 +188,94 @@ void ecs::registry::run_systems(void)
     }
     _last_time = current_ms;
 
+    this->update_events();
     for (auto &system_id : this->_enabled_systems) {
         auto system = this->_systems.at(system_id);
         system(*this, elapsed_time);
     }
-}   
\ No newline at end of file
+}
+
+void ecs::registry::update_events()
+{
+    for (auto &channel : this->_event_channels) {
+        channel.second->update();
+    }
+}
+
+ecs::registry::snapshot_id ecs::registry::snapshot()
+{
+    auto &slot = this->_snapshots[this->_next_snapshot % this->_snapshots.size()];
+
+    for (auto &[type, handler] : this->_snapshot_handlers) {
+        auto &buffer = slot.pools[type];
+
+        if (handler.last_buffer && !handler.dirty(*this)) {
+            buffer = handler.last_buffer;
+            continue;
+        }
+        // Reuse the allocation of the overwritten snapshot if nobody else shares it
+        std::shared_ptr<void> recycled = (buffer && buffer.use_count() == 1) ? std::move(buffer) : nullptr;
+        buffer = handler.save(*this, std::move(recycled));
+        handler.last_buffer = buffer;
+    }
+    for (auto it = slot.pools.begin(); it != slot.pools.end();) {
+        if (this->_snapshot_handlers.find(it->first) == this->_snapshot_handlers.end()) {
+            it = slot.pools.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    slot.unused_entities.assign(this->_unused_entities.begin(), this->_unused_entities.begin() + this->_unused_count);
+    slot.total_entity_count = this->_total_entity_count;
+    if (!this->_last_relations || this->_last_relations->revision() != this->_hierarchy.revision()) {
+        if (slot.relations && slot.relations.use_count() == 1) {
+            *slot.relations = this->_hierarchy;
+            this->_last_relations = slot.relations;
+        } else {
+            this->_last_relations = std::make_shared<hierarchy>(this->_hierarchy);
+        }
+    }
+    slot.relations = this->_last_relations;
+    slot.id = this->_next_snapshot;
+    slot.valid = true;
+    return this->_next_snapshot++;
+}
+
+void ecs::registry::restore(snapshot_id id)
+{
+    auto &slot = this->_snapshots[id % this->_snapshots.size()];
+
+    if (!slot.valid || slot.id != id) {
+        throw std::out_of_range("Snapshot " + std::to_string(id) + " is no longer available");
+    }
+    for (auto &[type, handler] : this->_snapshot_handlers) {
+        auto it = slot.pools.find(type);
+        std::shared_ptr<void> buffer = (it != slot.pools.end()) ? it->second : nullptr;
+
+        if (!buffer || handler.last_buffer != buffer || handler.dirty(*this)) {
+            handler.load(*this, buffer);
+        }
+        handler.last_buffer = buffer;
+    }
+    this->_unused_entities = slot.unused_entities;
+    this->_unused_count = slot.unused_entities.size();
+    this->_total_entity_count = slot.total_entity_count;
+    this->rebuild_released_entities();
+    if (slot.relations->revision() != this->_hierarchy.revision()) {
+        this->_hierarchy = *slot.relations;
+    }
+    this->_last_relations = slot.relations;
+}
+
+void ecs::registry::set_snapshot_capacity(std::size_t capacity)
+{
+    if (capacity == 0) {
+        throw std::invalid_argument("Snapshot capacity must be at least 1");
+    }
+    this->_snapshots.clear();
+    this->_snapshots.resize(capacity);
+    for (auto &handler : this->_snapshot_handlers) {
+        handler.second.last_buffer = nullptr;
+    }
+    this->_last_relations = nullptr;
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#ifndef EVENT_CHANNEL_TPP_
+    #define EVENT_CHANNEL_TPP_
+
+#include "event_channel.hpp"
+
+namespace ecs {
+
+template <class Event>
+event_channel<Event>::event_channel(event_channel const &other) :
+    _front(other._front),
+    _back(other._back),
+    _front_start(other._front_start)
+{
+    std::lock_guard<std::mutex> lock(other._mutex);
+
+    for (auto const &buffer : other._thread_buffers) {
+        this->_back.insert(this->_back.end(), buffer->events.begin(), buffer->events.end());
+    }
+}
+
+template <class Event>
+template <class... Params>
+void event_channel<Event>::send(Params &&...p)
+{
+    this->_back.emplace_back(std::forward<Params>(p)...);
+}
+
+template <class Event>
+template <class... Params>
+void event_channel<Event>::send_concurrent(Params &&...p)
+{
+    this->local_buffer().emplace_back(std::forward<Params>(p)...);
+}
+
+template <class Event>
+event_range<Event> event_channel<Event>::read(event_reader<Event> &reader) const
+{
+    std::size_t end = this->_front_start + this->_front.size();
+    std::size_t first = std::max(reader.cursor, this->_front_start);
+
+    reader.cursor = end;
+    if (first >= end) {
+        return event_range<Event>(nullptr, nullptr);
+    }
+    Event const *data = this->_front.data();
+    return event_range<Event>(data + (first - this->_front_start), data + this->_front.size());
+}
+
+template <class Event>
+event_range<Event> event_channel<Event>::read_all() const
+{
+    return event_range<Event>(this->_front.data(), this->_front.data() + this->_front.size());
+}
+
+template <class Event>
+void event_channel<Event>::update()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        for (auto &buffer : this->_thread_buffers) {
+            std::move(buffer->events.begin(), buffer->events.end(), std::back_inserter(this->_back));
+            buffer->events.clear();
+        }
+        // A thread that exited cannot send anymore, nor use its cached pointer to the buffer
+        this->_thread_buffers.erase(std::remove_if(this->_thread_buffers.begin(), this->_thread_buffers.end(),
+            [](std::unique_ptr<thread_buffer_t> const &buffer) {
+                return buffer->owner.expired();
+            }), this->_thread_buffers.end());
+    }
+    this->_front_start += this->_front.size();
+    this->_front.swap(this->_back);
+    this->_back.clear();
+}
+
+template <class Event>
+std::unique_ptr<ievent_channel> event_channel<Event>::clone() const
+{
+    return std::make_unique<event_channel<Event>>(*this);
+}
+
+template <class Event>
+std::vector<Event> &event_channel<Event>::local_buffer()
+{
+    // Remembers only the last channel used by the thread, so it never grows
+    thread_local struct {
+        std::size_t id = 0;
+        std::vector<Event> *buffer = nullptr;
+    } cache;
+
+    if (cache.id == this->_id) {
+        return *cache.buffer;
+    }
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto const &token = thread_token();
+    auto it = std::find_if(this->_thread_buffers.begin(), this->_thread_buffers.end(),
+        [&token](std::unique_ptr<thread_buffer_t> const &buffer) {
+            return !buffer->owner.owner_before(token) && !token.owner_before(buffer->owner);
+        });
+
+    if (it == this->_thread_buffers.end()) {
+        this->_thread_buffers.push_back(std::make_unique<thread_buffer_t>());
+        this->_thread_buffers.back()->owner = token;
+        it = std::prev(this->_thread_buffers.end());
+    }
+    cache.id = this->_id;
+    cache.buffer = &(*it)->events;
+    return (*it)->events;
+}
+
+template <class Event>
+std::shared_ptr<void> const &event_channel<Event>::thread_token()
+{
+    thread_local std::shared_ptr<void> token = std::make_shared<char>();
+
+    return token;
+}
+
+}
+
+#endif /* !EVENT_CHANNEL_TPP_ */
@@ -0,0 +1,49 @@
+#include <utility>
+
+#ifndef HIERARCHY_TPP_
+    #define HIERARCHY_TPP_
+
+#include "hierarchy.hpp"
+
+namespace ecs {
+
+template <class Function>
+void hierarchy::each(Function &&f) const
+{
+    for (auto const &link : this->_order) {
+        if (link.parent == npos) {
+            f(entity(link.entity), std::optional<entity>());
+        } else {
+            f(entity(link.entity), std::optional<entity>(entity(link.parent)));
+        }
+    }
+}
+
+template <class Component, class Function>
+void hierarchy::propagate(sparse_array<Component> &components, Function &&f) const
+{
+    auto data = components.begin();
+    std::size_t size = components.size();
+    std::vector<Component *> cache(this->_order.size(), nullptr);
+    std::vector<std::size_t> ancestors;
+
+    for (std::size_t i = 0; i < this->_order.size(); i++) {
+        auto const &link = this->_order[i];
+
+        // Positions of the ancestors whose subtree contains i, the last one being the parent
+        while (!ancestors.empty() && ancestors.back() + this->_order[ancestors.back()].subtree_size <= i) {
+            ancestors.pop_back();
+        }
+        if (link.entity < size && data[link.entity].has_value()) {
+            cache[i] = &*data[link.entity];
+        }
+        if (link.parent != npos && cache[i] && cache[ancestors.back()]) {
+            f(std::as_const(*cache[ancestors.back()]), *cache[i]);
+        }
+        ancestors.push_back(i);
+    }
+}
+
+}
+
+#endif /* !HIERARCHY_TPP_ */
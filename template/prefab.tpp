@@ -0,0 +1,43 @@
+#include <utility>
+#include <algorithm>
+
+#ifndef PREFAB_TPP_
+    #define PREFAB_TPP_
+
+#include "prefab.hpp"
+
+namespace ecs {
+
+template <class Component, class... Params>
+prefab &prefab::set(Params &&...p)
+{
+    this->_columns[typeid(Component)] = column_t{
+        [](registry const &reg) {
+            reg.get_components<Component>();
+        },
+        [value = Component(std::forward<Params>(p)...)](registry &reg, std::vector<entity> const &entities) {
+            auto &components = reg.get_components<Component>();
+
+            if (entities.empty()) {
+                return;
+            }
+            components.ensure_size(*std::max_element(entities.begin(), entities.end()));
+            auto data = components.begin();
+            for (auto const &e : entities) {
+                data[e] = value;
+            }
+        }
+    };
+    return *this;
+}
+
+template <class Component>
+prefab &prefab::unset()
+{
+    this->_columns.erase(typeid(Component));
+    return *this;
+}
+
+}
+
+#endif /* !PREFAB_TPP_ */
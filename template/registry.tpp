@@ -1,27 +1,14 @@
 #include <stdexcept>
 #include <iostream>
 #include <chrono>
-#include <cxxabi.h>
 #include <memory>
+#include <algorithm>
 
 #ifndef REGISTRY_TPP_
     #define REGISTRY_TPP_
 
 #include "registry.hpp"
-
-template <typename T>
-static std::string get_type_name()
-{
-    const char* mangled = typeid(T).name();
-    int status = 0;
-
-    std::unique_ptr<char, void(*)(void*)> demangled(
-        abi::__cxa_demangle(mangled, nullptr, nullptr, &status),
-        std::free
-    );
-
-    return (status == 0) ? demangled.get() : mangled;
-}
+#include "type_name.hpp"
 
 
 namespace ecs {
@@ -48,6 +35,61 @@ sparse_array<Component> &registry::register_component()
                 optional_component.reset();
             }
         };
+        this->_pool_handlers[type] = pool_handler_t{
+            [](registry const &reg) {
+                auto const &array = reg.get_components<Component>();
+                std::size_t live = array.count();
+                std::size_t slot_size = sizeof(typename sparse_array<Component>::value_type);
+
+                return memory_stats_t{
+                    get_type_name<Component>(),
+                    live,
+                    array.size(),
+                    array.capacity(),
+                    array.size() * slot_size,
+                    array.capacity() * slot_size,
+                    array.size() ? static_cast<double>(array.size() - live) / array.size() : 0.0
+                };
+            },
+            [](registry &reg) {
+                reg.shrink<Component>();
+            },
+            [](registry &reg, std::size_t from, std::size_t to) {
+                auto &array = reg.get_components<Component>();
+                if (array.size() <= from || !array[from].has_value()) {
+                    return;
+                }
+                array[to] = std::move(array[from]);
+                array.erase(from);
+            }
+        };
+        this->_snapshot_handlers[type] = snapshot_handler_t{
+            [](registry &reg, std::shared_ptr<void> recycled) -> std::shared_ptr<void> {
+                using container_t = typename sparse_array<Component>::container_t;
+                auto buffer = std::static_pointer_cast<container_t>(recycled);
+
+                if (!buffer) {
+                    buffer = std::make_shared<container_t>();
+                }
+                auto &array = reg.get_components<Component>();
+                array.copy_to(*buffer);
+                array.clear_dirty();
+                return buffer;
+            },
+            [](registry &reg, std::shared_ptr<void> const &buffer) {
+                using container_t = typename sparse_array<Component>::container_t;
+                static container_t const empty;
+                auto const *src = static_cast<container_t const *>(buffer.get());
+                auto &array = reg.get_components<Component>();
+
+                array.copy_from(src ? *src : empty);
+                array.clear_dirty();
+            },
+            [](registry const &reg) {
+                return reg.get_components<Component>().dirty();
+            },
+            nullptr
+        };
 
     }
     return std::any_cast<sparse_array<Component>&>(this->_components_arrays[type]);
@@ -59,6 +101,8 @@ void registry::unregister_component()
     std::type_index type = typeid(Component);
 
     this->_destructors.erase(type);
+    this->_pool_handlers.erase(type);
+    this->_snapshot_handlers.erase(type);
     this->_components_arrays.erase(type);
 }
 
@@ -86,6 +130,12 @@ sparse_array<Component> const& registry::get_components() const
     return std::any_cast<sparse_array<Component> const&>(this->_components_arrays.at(type));
 }
 
+template <class Component>
+void registry::shrink()
+{
+    this->get_components<Component>().shrink_to_fit();
+}
+
 
 /////////////////////////////////////////////////////////////
 //
@@ -127,6 +177,105 @@ void registry::register_system(Function&& f)
     );
 }
 
+template <class... Components, typename Function>
+void registry::register_budgeted_system(Function&& f, system_budget_t const &budget)
+{
+    static_assert(sizeof...(Components) > 0, "A budgeted system needs at least one component to iterate on");
+    auto &id = typeid(Function);
+    auto cursor = std::make_shared<system_cursor_t>();
+
+    _system_cursors[id] = cursor;
+    _systems[id] = [f = std::forward<Function>(f), budget, cursor](registry& reg, int elapsed_time) mutable {
+        // Reading the clock costs more than skipping a hole, so it is only read every few slots
+        constexpr std::size_t clock_interval = 64;
+        auto start = std::chrono::steady_clock::now();
+        std::size_t scanned = 0;
+        auto process = [&](auto &...arrays) {
+            std::size_t end = std::min({arrays.size()...});
+
+            while (cursor->position < end) {
+                if (budget.max_entities != 0 && scanned >= budget.max_entities) {
+                    return false;
+                }
+                if (budget.max_time.count() != 0 && scanned != 0 && scanned % clock_interval == 0
+                    && std::chrono::steady_clock::now() - start >= budget.max_time) {
+                    return false;
+                }
+                std::size_t idx = cursor->position++;
+                scanned++;
+                if ((arrays[idx].has_value() && ...)) {
+                    f(reg, elapsed_time, reg.entity_from_index(idx), *arrays[idx]...);
+                }
+            }
+            return true;
+        };
+
+        cursor->frames++;
+        if (process(reg.get_components<Components>()...)) {
+            cursor->last_pass_frames = cursor->frames;
+            cursor->frames = 0;
+            cursor->position = 0;
+        }
+    };
+}
+
+template<typename Function>
+std::size_t registry::get_system_pass_frames() const
+{
+    auto it = this->_system_cursors.find(typeid(Function));
+
+    if (it == this->_system_cursors.end()) {
+        return 0;
+    }
+    return it->second->last_pass_frames;
+}
+
+
+/////////////////////////////////////////////////////////////
+//
+// handle the events
+//
+/////////////////////////////////////////////////////////////
+template <class Event>
+event_channel<Event> &registry::register_event()
+{
+    auto &channel = this->_event_channels[typeid(Event)];
+
+    if (!channel) {
+        channel = std::make_unique<event_channel<Event>>();
+    }
+    return static_cast<event_channel<Event> &>(*channel);
+}
+
+template <class Event>
+event_channel<Event> &registry::get_events()
+{
+    auto it = this->_event_channels.find(typeid(Event));
+
+    if (it == this->_event_channels.end()) {
+        std::string error("Event not registered in registry ");
+        throw std::runtime_error(error + get_type_name<Event>());
+    }
+    return static_cast<event_channel<Event> &>(*it->second);
+}
+
+template <class Event, class... Params>
+void registry::send(Params &&...p)
+{
+    this->get_events<Event>().send(std::forward<Params>(p)...);
+}
+
+template <class Event, class... Params>
+void registry::send_concurrent(Params &&...p)
+{
+    this->get_events<Event>().send_concurrent(std::forward<Params>(p)...);
+}
+
+template <class Event>
+event_range<Event> registry::read(event_reader<Event> &reader)
+{
+    return this->get_events<Event>().read(reader);
+}
 
 template <typename Function>
 void registry::run_single_system()
@@ -145,6 +294,7 @@ void registry::unregister_syste()
     auto id = typeid(Function);
 
     this->_enabled_systems.erase(id);
+    this->_system_cursors.erase(id);
     this->_systems.erase(id);
 }
 
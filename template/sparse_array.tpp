@@ -1,4 +1,7 @@
 #include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
 #ifndef SPARSE_ARRAY_TPP
     #define SPARSE_ARRAY_TPP
@@ -45,6 +48,7 @@ template <typename Component>
 sparse_array<Component>& sparse_array<Component>::operator=(sparse_array const& other)
 {
     if (this != &other) {
+        _dirty = true;
         _data = other._data;
     }
     return *this;
@@ -54,6 +58,7 @@ template <typename Component>
 sparse_array<Component>& sparse_array<Component>::operator=(sparse_array&& other) noexcept
 {
     if (this != &other) {
+        _dirty = true;
         _data = std::move(other._data);
     }
     return *this;
@@ -62,6 +67,7 @@ sparse_array<Component>& sparse_array<Component>::operator=(sparse_array&& other
 template <typename Component>
 typename sparse_array<Component>::reference_type sparse_array<Component>::operator[](size_t idx)
 {
+    _dirty = true;
     ensure_size(idx);
     return _data.at(idx);
 }
@@ -85,6 +91,7 @@ typename sparse_array<Component>::const_reference_type sparse_array<Component>::
 template <typename Component>
 typename sparse_array<Component>::iterator sparse_array<Component>::begin()
 {
+    _dirty = true;
     return _data.begin();
 }
 
@@ -103,6 +110,7 @@ typename sparse_array<Component>::const_iterator sparse_array<Component>::cbegin
 template <typename Component>
 typename sparse_array<Component>::iterator sparse_array<Component>::end()
 {
+    _dirty = true;
     return _data.end();
 }
 
@@ -134,10 +142,38 @@ typename sparse_array<Component>::size_type sparse_array<Component>::size() cons
     return _data.size();
 }
 
+template <typename Component>
+typename sparse_array<Component>::size_type sparse_array<Component>::count() const
+{
+    return std::count_if(_data.begin(), _data.end(), [](value_type const &v) { return v.has_value(); });
+}
+
+template <typename Component>
+typename sparse_array<Component>::size_type sparse_array<Component>::capacity() const
+{
+    return _data.capacity();
+}
+
+template <typename Component>
+void sparse_array<Component>::shrink_to_fit()
+{
+    size_type last = _data.size();
+
+    while (last > 0 && !_data[last - 1].has_value()) {
+        --last;
+    }
+    if (last != _data.size() || _data.capacity() != _data.size()) {
+        _dirty = true;
+        _data.resize(last);
+        _data.shrink_to_fit();
+    }
+}
+
 template <typename Component>
 void sparse_array<Component>::ensure_size(size_type size)
 {
     if (_data.size() <= size) {
+        _dirty = true;
         _data.resize(size + 1);
     }
 }
@@ -155,6 +191,7 @@ void sparse_array<Component>::ensure_size(size_type size)
 template <typename Component>
 typename sparse_array<Component>::reference_type sparse_array<Component>::insert_at(size_type pos, Component const& value)
 {
+    _dirty = true;
     ensure_size(pos);
     _data[pos] = value;
     return _data[pos];
@@ -163,6 +200,7 @@ typename sparse_array<Component>::reference_type sparse_array<Component>::insert
 template <typename Component>
 typename sparse_array<Component>::reference_type sparse_array<Component>::insert_at(size_type pos, Component&& value)
 {
+    _dirty = true;
     ensure_size(pos);
     _data[pos] = std::move(value);
     return _data[pos];
@@ -172,6 +210,7 @@ template <typename Component>
 template <class... Params>
 typename sparse_array<Component>::reference_type sparse_array<Component>::emplace_at(size_type pos, Params&&... params)
 {
+    _dirty = true;
     ensure_size(pos);
     _data[pos].emplace(std::forward<Params>(params)...);
     return _data[pos];
@@ -191,6 +230,7 @@ template <typename Component>
 void sparse_array<Component>::erase(size_type pos)
 {
     if (pos < _data.size()) {
+        _dirty = true;
         _data[pos].reset();
     }
 }
@@ -212,5 +252,53 @@ typename sparse_array<Component>::size_type sparse_array<Component>::get_index(v
     return it != _data.end() ? std::distance(_data.begin(), it) : _data.size();
 }
 
+
+
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+//
+// SNAPSHOT
+//
+///////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////
+
+
+template <typename Component>
+bool sparse_array<Component>::dirty() const
+{
+    return _dirty;
+}
+
+template <typename Component>
+void sparse_array<Component>::clear_dirty()
+{
+    _dirty = false;
+}
+
+template <typename Component>
+void sparse_array<Component>::copy_to(container_t &dest) const
+{
+    copy_container(dest, _data);
+}
+
+template <typename Component>
+void sparse_array<Component>::copy_from(container_t const &src)
+{
+    copy_container(_data, src);
+}
+
+template <typename Component>
+void sparse_array<Component>::copy_container(container_t &dest, container_t const &src)
+{
+    if constexpr (std::is_trivially_copyable_v<value_type>) {
+        dest.resize(src.size());
+        if (!src.empty()) {
+            std::memcpy(dest.data(), src.data(), src.size() * sizeof(value_type));
+        }
+    } else {
+        dest = src;
+    }
+}
+
 #endif
 
@@ -0,0 +1,242 @@
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+#ifndef STATIC_REGISTRY_TPP_
+    #define STATIC_REGISTRY_TPP_
+
+#include "static_registry.hpp"
+#include "type_name.hpp"
+
+namespace ecs {
+
+
+/////////////////////////////////////////////////////////////
+//
+// Handle the components in the registry
+//
+/////////////////////////////////////////////////////////////
+template <class... Components>
+template <class Component>
+sparse_array<Component> &static_registry<Components...>::register_component()
+{
+    return this->get_components<Component>();
+}
+
+template <class... Components>
+template <class Component>
+sparse_array<Component> &static_registry<Components...>::get_components()
+{
+    static_assert(has_component<Component>, "Component not part of the static_registry");
+    return std::get<sparse_array<Component>>(this->_pools);
+}
+
+template <class... Components>
+template <class Component>
+sparse_array<Component> const &static_registry<Components...>::get_components() const
+{
+    static_assert(has_component<Component>, "Component not part of the static_registry");
+    return std::get<sparse_array<Component>>(this->_pools);
+}
+
+
+/////////////////////////////////////////////////////////////
+//
+// handle the entities
+//
+/////////////////////////////////////////////////////////////
+template <class... Components>
+entity static_registry<Components...>::create_entity()
+{
+    if (this->_unused_entities.empty()) {
+        return entity(this->_total_entity_count++);
+    }
+    std::size_t e = this->_unused_entities.back();
+    this->_unused_entities.pop_back();
+    this->_released_entities[e] = false;
+    return entity(e);
+}
+
+template <class... Components>
+entity static_registry<Components...>::entity_from_index(std::size_t idx)
+{
+    return entity(idx);
+}
+
+template <class... Components>
+void static_registry<Components...>::delete_entity(entity const &e)
+{
+    if (e >= this->_total_entity_count || (e < this->_released_entities.size() && this->_released_entities[e])) {
+        return;
+    }
+    (std::get<sparse_array<Components>>(this->_pools).erase(e), ...);
+    if (this->_released_entities.size() <= e) {
+        this->_released_entities.resize(e + 1);
+    }
+    this->_released_entities[e] = true;
+    this->_unused_entities.push_back(e);
+}
+
+
+/////////////////////////////////////////////////////////////
+//
+// handle components of an entity
+//
+/////////////////////////////////////////////////////////////
+template <class... Components>
+template <typename Component, typename ...Params>
+typename sparse_array<Component>::reference_type static_registry<Components...>::emplace_component(entity const &to, Params &&...p)
+{
+    return this->get_components<Component>().emplace_at(to, std::forward<Params>(p)...);
+}
+
+template <class... Components>
+template <typename Component>
+void static_registry<Components...>::remove_component(entity const &from)
+{
+    this->get_components<Component>().erase(from);
+}
+
+
+/////////////////////////////////////////////////////////////
+//
+// handle the different systems
+//
+/////////////////////////////////////////////////////////////
+template <class... Components>
+template <class... Used, typename Function>
+void static_registry<Components...>::run_system(Function&& f, int elapsed_time)
+{
+    f(*this, elapsed_time, this->get_components<Used>()...);
+}
+
+template <class... Components>
+template <class... Used, typename Function>
+void static_registry<Components...>::register_system(Function&& f)
+{
+    this->_systems[typeid(Function)] =
+        [f = std::forward<Function>(f)](static_registry &reg, int elapsed_time) mutable {
+            f(reg, elapsed_time, reg.get_components<Used>()...);
+        };
+}
+
+template <class... Components>
+template <typename Function>
+void static_registry<Components...>::unregister_syste()
+{
+    this->_enabled_systems.erase(typeid(Function));
+    this->_systems.erase(typeid(Function));
+}
+
+template <class... Components>
+template <typename Function>
+void static_registry<Components...>::enable_system()
+{
+    if (this->_systems.find(typeid(Function)) != this->_systems.end()) {
+        this->_enabled_systems.insert(typeid(Function));
+    } else {
+        std::cerr << "Not blocking error : system " << get_type_name<Function>() << " not registered" << std::endl;
+    }
+}
+
+template <class... Components>
+template <typename Function>
+void static_registry<Components...>::disable_system()
+{
+    this->_enabled_systems.erase(typeid(Function));
+}
+
+template <class... Components>
+void static_registry<Components...>::run_systems()
+{
+    this->run_registered_systems(this->next_elapsed_time());
+}
+
+template <class... Components>
+int static_registry<Components...>::next_elapsed_time()
+{
+    int elapsed_time = 0;
+    auto current_time = std::chrono::steady_clock::now();
+    int current_ms = std::chrono::duration_cast<std::chrono::milliseconds>(current_time.time_since_epoch()).count();
+
+    if (_last_time != 0) {
+        elapsed_time = current_ms - _last_time;
+    }
+    _last_time = current_ms;
+    return elapsed_time;
+}
+
+template <class... Components>
+void static_registry<Components...>::run_registered_systems(int elapsed_time)
+{
+    for (auto &system_id : this->_enabled_systems) {
+        this->_systems.at(system_id)(*this, elapsed_time);
+    }
+}
+
+template <class... Components>
+template <typename Function>
+void static_registry<Components...>::run_single_system()
+{
+    auto it = this->_systems.find(typeid(Function));
+
+    if (it != this->_systems.end()) {
+        it->second(*this, 0);
+    }
+}
+
+
+
+/////////////////////////////////////////////////////////////
+//
+// systems known at compile time
+//
+/////////////////////////////////////////////////////////////
+template <class... Components>
+template <class... Systems>
+template <class System>
+System &static_registry<Components...>::with_systems<Systems...>::get_system()
+{
+    constexpr std::size_t index = system_index<System>();
+
+    static_assert(index < sizeof...(Systems), "System not part of the static_registry");
+    return std::get<index>(this->_static_systems).system;
+}
+
+template <class... Components>
+template <class... Systems>
+void static_registry<Components...>::with_systems<Systems...>::run_systems()
+{
+    int elapsed_time = this->next_elapsed_time();
+
+    std::apply([this, elapsed_time](auto &...entries) {
+        (this->run_entry(entries, elapsed_time), ...);
+    }, this->_static_systems);
+    this->run_registered_systems(elapsed_time);
+}
+
+template <class... Components>
+template <class... Systems>
+template <class System, std::size_t I>
+constexpr std::size_t static_registry<Components...>::with_systems<Systems...>::system_index()
+{
+    if constexpr (I == sizeof...(Systems)) {
+        return I;
+    } else if constexpr (std::is_same_v<typename std::tuple_element_t<I, std::tuple<Systems...>>::system_type, System>) {
+        return I;
+    } else {
+        return system_index<System, I + 1>();
+    }
+}
+
+template <class... Components>
+template <class... Systems>
+template <class System, class... Used>
+void static_registry<Components...>::with_systems<Systems...>::run_entry(static_system<System, Used...> &entry, int elapsed_time)
+{
+    entry.system(*this, elapsed_time, this->template get_components<Used>()...);
+}
+
+}
+
+#endif /* !STATIC_REGISTRY_TPP_ */
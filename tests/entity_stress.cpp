@@ -0,0 +1,97 @@
+#include "registry.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::is_move_constructible_v<ecs::registry>, "ecs::registry must stay movable");
+static_assert(std::is_move_assignable_v<ecs::registry>, "ecs::registry must stay movable");
+static_assert(std::is_copy_constructible_v<ecs::registry>, "ecs::registry must stay copyable");
+static_assert(std::is_copy_assignable_v<ecs::registry>, "ecs::registry must stay copyable");
+
+static void check(bool condition, char const *message)
+{
+    if (!condition) {
+        std::cerr << "entity_stress: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+int main()
+{
+    constexpr std::size_t recycled = 5000;
+    constexpr std::size_t per_thread = 20000;
+    constexpr std::size_t block = 16;
+
+    for (std::size_t threads = 1; threads <= 16; threads *= 2) {
+        ecs::registry reg;
+
+        for (std::size_t i = 0; i < recycled * 2; i++) {
+            reg.create_entity();
+        }
+        for (std::size_t i = 0; i < recycled * 2; i += 2) {
+            reg.delete_entity(ecs::entity(i));
+        }
+
+        std::vector<std::vector<std::size_t>> ids(threads);
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; t++) {
+            workers.emplace_back([&reg, &ids, t]() {
+                for (std::size_t i = 0; i < per_thread; i++) {
+                    if (i % 100 == 0) {
+                        auto range = reg.reserve_entities(block);
+                        for (std::size_t k = 0; k < range.count; k++) {
+                            ids[t].push_back(range[k]);
+                        }
+                    } else {
+                        ids[t].push_back(reg.create_entity());
+                    }
+                }
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        std::vector<std::size_t> all;
+        for (auto const &list : ids) {
+            all.insert(all.end(), list.begin(), list.end());
+        }
+        std::sort(all.begin(), all.end());
+        check(std::adjacent_find(all.begin(), all.end()) == all.end(), "an id was handed out twice");
+        for (std::size_t i = 0; i < recycled * 2; i += 2) {
+            check(std::binary_search(all.begin(), all.end(), i), "a recycled id was lost");
+        }
+        check(reg.create_entity() == ecs::entity(recycled * 2 + all.size() - recycled),
+            "the entity count does not match the ids handed out");
+
+        ecs::registry moved(std::move(reg));
+        check(moved.create_entity() == ecs::entity(recycled * 2 + all.size() - recycled + 1),
+            "moving the registry lost the entity count");
+
+        // Deleting twice, including ids recycled by the threads above, must release them once
+        moved.delete_entity(ecs::entity(0));
+        moved.delete_entity(ecs::entity(0));
+        moved.delete_entity(ecs::entity(1));
+        moved.delete_entity(ecs::entity(1));
+        moved.delete_entity(ecs::entity(recycled * 100 + all.size()));
+        std::vector<std::size_t> reused = {moved.create_entity(), moved.create_entity(), moved.create_entity()};
+        std::sort(reused.begin(), reused.end());
+        check(reused[0] == 0 && reused[1] == 1 && reused[2] > 1, "a double delete released an id twice");
+        moved.delete_entity(ecs::entity(reused[2]));
+        moved.delete_entity(ecs::entity(reused[2]));
+        moved.compact();
+        check(moved.create_entity() == ecs::entity(reused[2]), "compact() lost track of a deleted id");
+
+        // A copy keeps its own entity count and events
+        moved.register_event<int>().send(1);
+        moved.send_concurrent<int>(2);
+        ecs::registry copy(moved);
+        copy.update_events();
+        check(copy.get_events<int>().read_all().size() == 2, "copying the registry lost events");
+        check(moved.create_entity() == copy.create_entity(), "copying the registry lost the entity count");
+    }
+    return 0;
+}
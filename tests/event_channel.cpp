@@ -0,0 +1,58 @@
+#include "event_channel.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+static void check(bool condition, char const *message)
+{
+    if (!condition) {
+        std::cerr << "event_channel: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+static std::vector<int> front(ecs::event_channel<int> const &channel)
+{
+    auto events = channel.read_all();
+
+    return std::vector<int>(events.begin(), events.end());
+}
+
+int main()
+{
+    ecs::event_channel<int> channel;
+    ecs::event_reader<int> reader;
+
+    // The thread buffers are merged in the order the threads first sent an event
+    for (int round = 0; round < 100; round++) {
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 8; t++) {
+            threads.emplace_back([&channel, t]() {
+                channel.send_concurrent(t * 2);
+                channel.send_concurrent(t * 2 + 1);
+            });
+            threads.back().join();
+        }
+        channel.send(-1);
+        channel.update();
+
+        std::vector<int> expected = {-1};
+        for (int i = 0; i < 16; i++) {
+            expected.push_back(i);
+        }
+        check(front(channel) == expected, "the events of the threads are not merged in order");
+        check(channel.read(reader).size() == expected.size(), "the reader missed events");
+    }
+
+    // A copy keeps the events that are not merged yet
+    channel.send_concurrent(1);
+    ecs::event_channel<int> copy(channel);
+    copy.update();
+    check(front(copy) == std::vector<int>{1}, "the copy lost the events of a thread");
+    channel.update();
+    channel.update();
+    check(front(channel).empty(), "an event was merged twice");
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "hierarchy.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+static void check(bool condition, char const *message)
+{
+    if (!condition) {
+        std::cerr << "hierarchy: " << message << std::endl;
+        std::exit(1);
+    }
+}
+
+static bool is_ancestor(ecs::hierarchy const &h, std::size_t ancestor, std::size_t e)
+{
+    for (auto p = h.parent(ecs::entity(e)); p; p = h.parent(*p)) {
+        if (*p == ancestor) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Check the links against the depth-first order: parents first, subtrees contiguous
+static void check_consistent(ecs::hierarchy const &h)
+{
+    std::vector<std::size_t> order;
+
+    h.each([&](ecs::entity const &e, std::optional<ecs::entity> const &parent) {
+        check(parent == h.parent(e), "each() gives a wrong parent");
+        order.push_back(e);
+    });
+    check(order.size() == h.size(), "each() does not visit every entity");
+    for (std::size_t i = 0; i < order.size(); i++) {
+        ecs::entity e(order[i]);
+        std::size_t size = 1;
+
+        for (auto c = h.first_child(e); c; c = h.next_sibling(*c)) {
+            check(h.parent(*c) == e, "a child does not point to its parent");
+            size += h.subtree_size(*c);
+        }
+        check(h.subtree_size(e) == size, "a subtree size does not match the children");
+        check(i + size <= order.size(), "a subtree goes past the end of the order");
+        for (std::size_t k = i + 1; k < i + size; k++) {
+            check(is_ancestor(h, order[i], order[k]), "a subtree is not contiguous");
+        }
+    }
+}
+
+struct depth {
+    int value;
+
+    depth(int v) : value(v) {}
+};
+
+int main()
+{
+    ecs::hierarchy h;
+
+    // 0 -> (1 -> (3, 4), 2 -> (5)), 6 -> (7)
+    h.set_parent(ecs::entity(2), ecs::entity(0));
+    h.set_parent(ecs::entity(1), ecs::entity(0));
+    h.set_parent(ecs::entity(4), ecs::entity(1));
+    h.set_parent(ecs::entity(3), ecs::entity(1));
+    h.set_parent(ecs::entity(5), ecs::entity(2));
+    h.set_parent(ecs::entity(7), ecs::entity(6));
+    check_consistent(h);
+    check(h.size() == 8 && h.subtree_size(ecs::entity(0)) == 6, "wrong sizes after building");
+
+    // Reparenting to an entity placed later, then back to one placed earlier
+    h.set_parent(ecs::entity(1), ecs::entity(7));
+    check_consistent(h);
+    check(h.subtree_size(ecs::entity(6)) == 5 && h.subtree_size(ecs::entity(0)) == 3,
+        "wrong sizes after moving a subtree forward");
+    h.set_parent(ecs::entity(1), ecs::entity(5));
+    check_consistent(h);
+    check(h.subtree_size(ecs::entity(6)) == 2 && h.subtree_size(ecs::entity(0)) == 6,
+        "wrong sizes after moving a subtree backward");
+
+    bool thrown = false;
+    try {
+        h.set_parent(ecs::entity(2), ecs::entity(3));
+    } catch (std::invalid_argument const &) {
+        thrown = true;
+    }
+    check(thrown, "a cycle was accepted");
+    check_consistent(h);
+
+    h.remove_parent(ecs::entity(1));
+    check_consistent(h);
+    check(!h.parent(ecs::entity(1)) && h.subtree_size(ecs::entity(0)) == 3, "remove_parent() kept the link");
+    h.set_parent(ecs::entity(1), ecs::entity(0));
+
+    // Propagation matches a naive walk up the parents
+    sparse_array<depth> depths;
+    for (std::size_t e = 0; e < 8; e++) {
+        depths.emplace_at(e, 1);
+    }
+    h.propagate(depths, [](depth const &parent, depth &child) {
+        child.value = parent.value + 1;
+    });
+    for (std::size_t e = 0; e < 8; e++) {
+        int expected = 1;
+        for (auto p = h.parent(ecs::entity(e)); p; p = h.parent(*p)) {
+            expected++;
+        }
+        check(depths[e]->value == expected, "propagate() gives a wrong value");
+    }
+
+    // Renaming keeps the parent and the children
+    h.rename(ecs::entity(1), ecs::entity(10));
+    check_consistent(h);
+    check(!h.contains(ecs::entity(1)) && h.parent(ecs::entity(10)) == ecs::entity(0)
+        && h.parent(ecs::entity(3)) == ecs::entity(10), "rename() lost a link");
+
+    // Erasing a single entity turns its children into roots
+    h.erase(ecs::entity(10));
+    check_consistent(h);
+    check(!h.contains(ecs::entity(10)) && !h.parent(ecs::entity(3)) && !h.parent(ecs::entity(4))
+        && h.subtree_size(ecs::entity(0)) == 3 && h.size() == 7, "erase() left a wrong tree");
+
+    // Erasing a subtree removes the descendants
+    auto removed = h.erase_subtree(ecs::entity(0));
+    check_consistent(h);
+    check(removed.size() == 3 && removed[0] == ecs::entity(0) && h.size() == 4, "erase_subtree() left a wrong tree");
+    for (auto const &e : removed) {
+        check(!h.contains(e), "erase_subtree() kept an entity");
+    }
+    return 0;
+}